@@ -0,0 +1,135 @@
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+//Bibliothèques:
+#include <stdio.h>
+#include <stdlib.h>
+#include "board.h"
+#include "autojeu.h"
+#define NB_CASES (DIMENSION * DIMENSION)
+//-------------------------------------------------------------------------------------------------------------//
+static _Thread_local FILE * script = NULL; /*script de rejeu du thread, NULL si les appels ne sont pas enregistrés*/
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+void enregistrer_appels(FILE * fichier){
+	script = fichier;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Appels au moteur faits par ce module, écrits dans le script s'il y en a un*/
+static enum return_code placer(board game, int l, int c){
+	if (script != NULL){
+		fprintf(script, "place %d %d\n", l, c);
+	}
+	return place_piece(game, l, c);
+}
+
+static enum return_code inserer(board game, int l, int c){
+	if (script != NULL){
+		fprintf(script, "insert %d %d\n", l, c);
+	}
+	return insert_pawn(game, l, c);
+}
+
+static enum return_code deplacer(board game, int l1, int c1, int l2, int c2){
+	if (script != NULL){
+		fprintf(script, "quick %d %d %d %d\n", l1, c1, l2, c2);
+	}
+	return quick_move(game, l1, c1, l2, c2);
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui mélange un tableau de cases (numérotées l * DIMENSION + c)*/
+static void melanger(int * cases, int nb, unsigned int * graine){
+	for (int i = nb - 1; i > 0; i--){
+		int j = rand_r(graine) % (i + 1);
+		int temp = cases[i];
+		cases[i] = cases[j];
+		cases[j] = temp;
+	}
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui place aléatoirement les pièces de chaque joueur avant le début de la partie*/
+void placer_aleatoirement(board game, unsigned int * graine){
+	int cases[NB_CASES];
+	for (int i = 0; i < NB_CASES; i++){
+		cases[i] = i;
+	}
+	melanger(cases, NB_CASES, graine);
+	/*place_piece refuse les cases hors du camp du joueur courant : on parcourt les cases mélangées jusqu'à la fin du set-up*/
+	while (piece_to_place(game) != NONE){
+		for (int i = 0; i < NB_CASES && piece_to_place(game) != NONE; i++){
+			placer(game, cases[i] / DIMENSION, cases[i] % DIMENSION);
+		}
+	}
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui tente de réintroduire un pion pris sur une case aléatoire, renvoie 1 si elle y parvient*/
+static int reintroduire(board game, unsigned int * graine){
+	int cases[NB_CASES];
+	if (get_nb_pieces_on_board(game, current_player(game)) >= NB_INITIAL_PIECES){
+		return 0;
+	}
+	for (int i = 0; i < NB_CASES; i++){
+		cases[i] = i;
+	}
+	melanger(cases, NB_CASES, graine);
+	for (int i = 0; i < NB_CASES; i++){
+		if (inserer(game, cases[i] / DIMENSION, cases[i] % DIMENSION) == OK){
+			return 1;
+		}
+	}
+	return 0;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui joue un coup aléatoire légal pour le joueur courant*/
+int jouer_coup_aleatoire(board game, unsigned int * graine){
+	int pieces[NB_CASES];
+	int nb_pieces = 0;
+	int cibles[NB_CASES];
+	/*Une réintroduction n'est acceptée par insert_pawn que si aucune pièce ne peut jouer le chiffre prescrit*/
+	if (rand_r(graine) % 4 == 0 && reintroduire(game, graine)){
+		return 1;
+	}
+	for (int i = 0; i < NB_CASES; i++){
+		if (is_legal_move(game, i / DIMENSION, i % DIMENSION)){
+			pieces[nb_pieces++] = i;
+		}
+	}
+	melanger(pieces, nb_pieces, graine);
+	for (int p = 0; p < nb_pieces; p++){
+		int l = pieces[p] / DIMENSION;
+		int c = pieces[p] % DIMENSION;
+		int chiffre = get_digit(game, l, c);
+		int nb_cibles = 0;
+		/*Seules les cases à une distance au plus égale au chiffre, et de même parité, sont atteignables*/
+		for (int i = 0; i < NB_CASES; i++){
+			int distance = abs(i / DIMENSION - l) + abs(i % DIMENSION - c);
+			if (distance > 0 && distance <= chiffre && (chiffre - distance) % 2 == 0){
+				cibles[nb_cibles++] = i;
+			}
+		}
+		melanger(cibles, nb_cibles, graine);
+		for (int i = 0; i < nb_cibles; i++){
+			if (deplacer(game, l, c, cibles[i] / DIMENSION, cibles[i] % DIMENSION) == OK){
+				return 1;
+			}
+		}
+	}
+	return reintroduire(game, graine);
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui joue une partie complète avec des coups aléatoires*/
+player jouer_partie_aleatoire(board game, int max_coups, unsigned int * graine){
+	for (int coup = 0; coup < max_coups && get_winner(game) == NO_PLAYER; coup++){
+		if (!jouer_coup_aleatoire(game, graine)){
+			return NO_PLAYER;
+		}
+	}
+	return get_winner(game);
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
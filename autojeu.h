@@ -0,0 +1,27 @@
+#ifndef _AUTOJEU_H_
+#define _AUTOJEU_H_
+
+#include <stdio.h>
+#include "board.h"
+
+/*Fonctions permettant de faire jouer une partie sans joueur humain (coups aléatoires légaux).
+  Tout le hasard passe par la graine donnée en paramètre (rand_r), ce qui rend les parties
+  reproductibles et permet d'en jouer plusieurs en parallèle sur des plateaux différents.*/
+
+/*Écrit dans fichier, au format de rejeu (une ligne place, insert ou quick par appel, y compris ceux
+  que le moteur refuse), chaque appel au moteur fait ensuite par ces fonctions dans le thread courant.
+  NULL arrête l'enregistrement.*/
+void enregistrer_appels(FILE * fichier);
+
+/*Place aléatoirement les pièces de NORTH puis de SOUTH sur leurs deux lignes*/
+void placer_aleatoirement(board game, unsigned int * graine);
+
+/*Joue un coup aléatoire légal (déplacement ou réintroduction) pour le joueur courant.
+  Renvoie 1 si un coup a été joué, 0 si le joueur est bloqué*/
+int jouer_coup_aleatoire(board game, unsigned int * graine);
+
+/*Joue la partie déjà mise en place jusqu'à la victoire d'un joueur ou au plus max_coups coups.
+  Renvoie le gagnant, ou NO_PLAYER si la partie est nulle (limite atteinte ou joueur bloqué)*/
+player jouer_partie_aleatoire(board game, int max_coups, unsigned int * graine);
+
+#endif /*_AUTOJEU_H_*/
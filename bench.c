@@ -0,0 +1,167 @@
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+//Bibliothèques:
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "board.h"
+#include "autojeu.h"
+#include "chemin.h"
+#define NB_CASES (DIMENSION * DIMENSION)
+#define NB_APPELS 200000
+#define NB_PARTIES 2000
+#define MAX_COUPS 200
+//-------------------------------------------------------------------------------------------------------------//
+/*Mesure des performances : temps par appel (ns) des principales fonctions de board.h et chemin.h
+  sur une position fixe, puis nombre de parties aléatoires complètes jouées par seconde.
+  Les accesseurs sont mesurés sur les 36 cases. Les fonctions de chemin.h et quick_move sont mesurées
+  sur une pièce sélectionnable et ses cibles atteignables, sinon elles s'arrêteraient dès is_legal_move().
+  Les graines sont fixes et chaque mesure garde le meilleur temps sur nb_repetitions (5 par défaut),
+  pour que deux exécutions (ou deux variantes de compilation) soient comparables.
+  Chaque ligne affichée est de la forme : nom valeur unité
+
+  Utilisation : ./bench [nb_repetitions]*/
+//-------------------------------------------------------------------------------------------------------------//
+static volatile long puits; /*empêche le compilateur de supprimer les appels mesurés*/
+static int nb_repetitions = 5;
+/*Position mesurée, une pièce sélectionnable et ses cibles*/
+static board position;
+static int piece;
+static int cibles[NB_CASES];
+static int nb_cibles;
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui renvoie l'heure en nanosecondes*/
+long long maintenant(){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui exécute l'opération numérotée pour le i-ème appel : sur la case i de la position,
+  ou sur la pièce choisie et sa i-ème cible*/
+void operation(int numero, int i){
+	direction chemin[NB_DIGITS];
+	piece_moves deplacements;
+	board game = position;
+	board copie;
+	int cible = cibles[i % nb_cibles];
+	switch(numero){
+		case 0 : puits += get_digit(game, i / DIMENSION, i % DIMENSION);
+		break;
+		case 1 : puits += get_place_holder(game, i / DIMENSION, i % DIMENSION);
+		break;
+		case 2 : puits += is_king(game, i / DIMENSION, i % DIMENSION);
+		break;
+		case 3 : puits += is_legal_move(game, i / DIMENSION, i % DIMENSION);
+		break;
+		case 4 : puits += get_reachable(game, piece / DIMENSION, piece % DIMENSION);
+		break;
+		case 5 : puits += get_move_path(game, piece / DIMENSION, piece % DIMENSION,
+				cible / DIMENSION, cible % DIMENSION, chemin, NULL);
+		break;
+		case 6 : puits += get_moves(game, piece / DIMENSION, piece % DIMENSION, &deplacements);
+		break;
+		case 7 : copie = copy_game(game);
+			destroy_game(copie);
+		break;
+		case 8 : copie = copy_game(game);
+			puits += quick_move(copie, piece / DIMENSION, piece % DIMENSION, cible / DIMENSION, cible % DIMENSION);
+			destroy_game(copie);
+		break;
+	}
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui renvoie le meilleur temps moyen (ns) d'une opération sur nb_repetitions séries d'appels*/
+double mesurer(int numero){
+	double meilleur = -1;
+	for (int r = 0; r < nb_repetitions; r++){
+		long long debut = maintenant();
+		for (int n = 0; n < NB_APPELS; n++){
+			operation(numero, n % NB_CASES);
+		}
+		double temps = (double)(maintenant() - debut) / NB_APPELS;
+		if (meilleur < 0 || temps < meilleur){
+			meilleur = temps;
+		}
+	}
+	return meilleur;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui renvoie le meilleur nombre de parties aléatoires jouées par seconde*/
+double parties_par_seconde(board modele){
+	double meilleur = 0;
+	for (int r = 0; r < nb_repetitions; r++){
+		long long debut = maintenant();
+		for (unsigned int p = 0; p < NB_PARTIES; p++){
+			unsigned int graine = p + 1;
+			board game = copy_game(modele);
+			placer_aleatoirement(game, &graine);
+			puits += jouer_partie_aleatoire(game, MAX_COUPS, &graine);
+			destroy_game(game);
+		}
+		double debit = NB_PARTIES * 1e9 / (maintenant() - debut);
+		if (debit > meilleur){
+			meilleur = debit;
+		}
+	}
+	return meilleur;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui range dans piece la première pièce sélectionnable de la position qui a une cible,
+  et ses cibles dans cibles. Renvoie 0 si la position n'en a pas.*/
+int choisir_piece(){
+	for (int i = 0; i < NB_CASES; i++){
+		uint64_t atteignables = get_reachable(position, i / DIMENSION, i % DIMENSION);
+		if (atteignables != 0){
+			piece = i;
+			nb_cibles = 0;
+			for (int cible = 0; cible < NB_CASES; cible++){
+				if (atteignables & ((uint64_t)1 << cible)){
+					cibles[nb_cibles++] = cible;
+				}
+			}
+			return 1;
+		}
+	}
+	return 0;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+//Programme:
+int main(int argc, char ** argv){
+	const char * noms[] = {"get_digit", "get_place_holder", "is_king", "is_legal_move",
+		"get_reachable", "get_move_path", "get_moves", "copy_game+destroy_game", "copy_game+quick_move+destroy_game"};
+	nb_repetitions = argc > 1 ? atoi(argv[1]) : 5;
+	if (nb_repetitions <= 0){
+		fprintf(stderr, "Utilisation : %s [nb_repetitions]\n", argv[0]);
+		return 1;
+	}
+	unsigned int graine = 1;
+	srand(1);
+	board modele = new_random_game();
+	/*Position mesurée : quelques coups après le set-up*/
+	position = copy_game(modele);
+	placer_aleatoirement(position, &graine);
+	for (int coup = 0; coup < 6; coup++){
+		jouer_coup_aleatoire(position, &graine);
+	}
+	if (!choisir_piece()){
+		fprintf(stderr, "Aucune pièce sélectionnable dans la position mesurée\n");
+		return 1;
+	}
+	for (int numero = 0; numero < 9; numero++){
+		printf("%s %.1f ns\n", noms[numero], mesurer(numero));
+	}
+	printf("parties_par_seconde %.0f parties/s\n", parties_par_seconde(modele));
+	destroy_game(position);
+	destroy_game(modele);
+	return 0;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
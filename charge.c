@@ -0,0 +1,158 @@
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+//Bibliothèques:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "board.h"
+#define TAILLE_LIGNE 256
+//-------------------------------------------------------------------------------------------------------------//
+/*Client de charge pour serveur : ouvre nb_parties parties, fait placer toutes les pièces, puis
+  demande nb_tours coups "ai" à chaque partie, en envoyant les commandes d'un tour d'un seul bloc.
+  Chaque réponse est vérifiée, puis l'état et les statistiques de chaque partie sont relus.
+  Le programme affiche le débit en coups par seconde et la latence moyenne mesurée par le serveur,
+  et renvoie 1 si une réponse est incorrecte ou si le débit est inférieur au seuil demandé.
+
+  Utilisation : ./charge [socket] [nb_parties] [nb_tours] [seuil_coups_par_seconde]*/
+//-------------------------------------------------------------------------------------------------------------//
+static FILE * entree;
+static FILE * sortie;
+static int nb_erreurs = 0;
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui renvoie l'heure en secondes*/
+double maintenant(){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui lit la réponse suivante du serveur dans ligne, et la compte comme erreur
+  si elle ne commence pas par l'un des préfixes attendus (séparés par des '|')*/
+void lire_reponse(char * ligne, const char * attendus, const char * commande){
+	if (fgets(ligne, TAILLE_LIGNE, entree) == NULL){
+		fprintf(stderr, "Connexion fermée par le serveur\n");
+		exit(1);
+	}
+	char copie[TAILLE_LIGNE];
+	strcpy(copie, attendus);
+	for (char * prefixe = strtok(copie, "|"); prefixe != NULL; prefixe = strtok(NULL, "|")){
+		if (strncmp(ligne, prefixe, strlen(prefixe)) == 0){
+			return;
+		}
+	}
+	if (nb_erreurs++ < 10){
+		fprintf(stderr, "Réponse inattendue à %s : %s", commande, ligne);
+	}
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui se connecte au serveur, en réessayant le temps qu'il démarre*/
+int connecter(char * chemin){
+	struct sockaddr_un adresse;
+	memset(&adresse, 0, sizeof adresse);
+	adresse.sun_family = AF_UNIX;
+	strncpy(adresse.sun_path, chemin, sizeof adresse.sun_path - 1);
+	for (int essai = 0; essai < 100; essai++){
+		int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (fd >= 0 && connect(fd, (struct sockaddr *)&adresse, sizeof adresse) == 0){
+			return fd;
+		}
+		close(fd);
+		usleep(20000);
+	}
+	return -1;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+//Programme:
+int main(int argc, char ** argv){
+	char * chemin = argc > 1 ? argv[1] : "/tmp/sae_jeu.sock";
+	int nb_parties = argc > 2 ? atoi(argv[2]) : 1000;
+	int nb_tours = argc > 3 ? atoi(argv[3]) : 20;
+	double seuil = argc > 4 ? atof(argv[4]) : 10000;
+	char ligne[TAILLE_LIGNE];
+	int fd = connecter(chemin);
+	if (fd < 0 || nb_parties <= 0 || nb_tours <= 0){
+		fprintf(stderr, "Utilisation : %s [socket] [nb_parties] [nb_tours] [seuil_coups_par_seconde]\n", argv[0]);
+		return 1;
+	}
+	entree = fdopen(fd, "r");
+	sortie = fdopen(dup(fd), "w");
+	int * ids = malloc(nb_parties * sizeof(int));
+	for (int i = 0; i < nb_parties; i++){
+		fprintf(sortie, "new\n");
+		fflush(sortie);
+		lire_reponse(ligne, "OK ", "new");
+		ids[i] = atoi(ligne + 3);
+	}
+	/*Set-up : NORTH sur les trois premières colonnes des lignes 0 et 1, SOUTH sur les lignes 4 et 5*/
+	for (int i = 0; i < nb_parties; i++){
+		for (int l = 0; l < DIMENSION; l++){
+			if (l < 2 || l >= DIMENSION - 2){
+				for (int c = 0; c < NB_INITIAL_PIECES / 2; c++){
+					fprintf(sortie, "place %d %d %d\n", ids[i], l, c);
+				}
+			}
+		}
+		fflush(sortie);
+		for (int p = 0; p < 2 * NB_INITIAL_PIECES; p++){
+			lire_reponse(ligne, "OK", "place");
+		}
+	}
+	/*Un coup "ai" sur une partie terminée ou bloquée répond RULES : les deux réponses sont valides*/
+	long nb_coups = 0;
+	double debut = maintenant();
+	for (int tour = 0; tour < nb_tours; tour++){
+		for (int i = 0; i < nb_parties; i++){
+			fprintf(sortie, "ai %d\n", ids[i]);
+		}
+		fflush(sortie);
+		for (int i = 0; i < nb_parties; i++){
+			lire_reponse(ligne, "OK|RULES", "ai");
+			nb_coups++;
+		}
+	}
+	double debit = nb_coups / (maintenant() - debut);
+	int nb_gagnees = 0;
+	long long latence_totale = 0;
+	for (int i = 0; i < nb_parties; i++){
+		int joueur, prescrit, gagnant = NO_PLAYER;
+		char grille[TAILLE_LIGNE];
+		fprintf(sortie, "state %d\nstats %d\n", ids[i], ids[i]);
+		fflush(sortie);
+		lire_reponse(ligne, "OK ", "state");
+		if (sscanf(ligne, "OK %d %d %d %s", &joueur, &prescrit, &gagnant, grille) != 4
+				|| strlen(grille) != DIMENSION * DIMENSION){
+			nb_erreurs++;
+			fprintf(stderr, "État incorrect : %s", ligne);
+		}
+		nb_gagnees += gagnant != NO_PLAYER;
+		long coups = 0;
+		long long moyenne = 0, maximum = 0;
+		lire_reponse(ligne, "OK ", "stats");
+		if (sscanf(ligne, "OK %ld %lld %lld", &coups, &moyenne, &maximum) != 3 || coups < nb_tours){
+			nb_erreurs++;
+			fprintf(stderr, "Statistiques incorrectes : %s", ligne);
+		}
+		latence_totale += moyenne;
+		fprintf(sortie, "end %d\n", ids[i]);
+		fflush(sortie);
+		lire_reponse(ligne, "OK", "end");
+	}
+	printf("%ld coups en %d tours sur %d parties (%d terminées)\n", nb_coups, nb_tours, nb_parties, nb_gagnees);
+	printf("debit %.0f coups/s (seuil %.0f)\n", debit, seuil);
+	printf("latence moyenne dans le moteur %lld ns\n", latence_totale / nb_parties);
+	printf("%d réponse(s) incorrecte(s)\n", nb_erreurs);
+	free(ids);
+	fclose(entree);
+	fclose(sortie);
+	return nb_erreurs > 0 || debit < seuil;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
@@ -0,0 +1,166 @@
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+//Bibliothèques:
+#include <stddef.h>
+#include <stdint.h>
+#include "board.h"
+#include "chemin.h"
+#define BIT(l, c) ((uint64_t)1 << ((l) * DIMENSION + (c)))
+//-------------------------------------------------------------------------------------------------------------//
+/*Particularités de move_one_step() dans board.o, que les chemins renvoyés doivent respecter pour être rejoués :
+  * E déplace vers les colonnes décroissantes et W vers les colonnes croissantes, à l'inverse de board.h,
+  * les cases déjà traversées ne sont pas vérifiées, mais une étape vers S est refusée (::RULES)
+    dès que la pièce n'est plus ni sur la ligne ni sur la colonne de départ.
+  quick_move() n'a pas ces défauts : l'ensemble des cases atteignables suit donc les règles du jeu,
+  et pour chaque case on garde de préférence un chemin que move_one_step() accepte aussi.*/
+//-------------------------------------------------------------------------------------------------------------//
+/*Recherche en cours : le plateau n'est lu que sur les cases que la pièce peut traverser,
+  l'occupation de chaque case étant gardée après sa première lecture*/
+typedef struct {
+	board game;
+	player joueur;
+	int depart;
+	int chiffre;
+	uint64_t lues; /*cases dont l'occupation a été lue*/
+	uint64_t occupes;
+	uint64_t adverses;
+	piece_moves * resultat;
+} recherche;
+
+static const int dl[] = {-1, 1, 0, 0}; /*déplacement en ligne pour N, S, E, W*/
+static const int dc[] = {0, 0, -1, 1}; /*déplacement en colonne pour N, S, E, W (voir plus haut)*/
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui lit l'occupation de la case (l, c) si ce n'est pas déjà fait*/
+static void lire_case(recherche * r, int l, int c){
+	if (r->lues & BIT(l, c)){
+		return;
+	}
+	r->lues |= BIT(l, c);
+	player p = get_place_holder(r->game, l, c);
+	if (p != NO_PLAYER){
+		r->occupes |= BIT(l, c);
+		if (p != r->joueur){
+			r->adverses |= BIT(l, c);
+		}
+	}
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Parcours en profondeur : la pièce est en (l, c) après pas étapes, en ayant traversé les cases de visitees.
+  rejouable indique si move_one_step() accepte le chemin jusqu'ici. Une case occupée ne peut être atteinte qu'à la dernière étape, et seulement si elle est adverse.*/
+static void explorer(recherche * r, int l, int c, int pas, uint64_t visitees, int rejouable, direction * chemin){
+	piece_moves * m = r->resultat;
+	/*get_digit ne dépasse jamais NB_DIGITS : le second test borne seulement le parcours pour le compilateur*/
+	if (pas == r->chiffre || pas == NB_DIGITS){
+		int arrivee = l * DIMENSION + c;
+		if (!(m->reachable & BIT(l, c)) || (rejouable && !(m->replayable & BIT(l, c)))){
+			m->reachable |= BIT(l, c);
+			if (rejouable){
+				m->replayable |= BIT(l, c);
+			}
+			for (int i = 0; i < pas; i++){
+				m->paths[arrivee][i] = chemin[i];
+			}
+		}
+		return;
+	}
+	for (int d = N; d <= W; d++){
+		int l2 = l + dl[d];
+		int c2 = c + dc[d];
+		if (l2 < 0 || l2 >= DIMENSION || c2 < 0 || c2 >= DIMENSION || (visitees & BIT(l2, c2))){
+			continue;
+		}
+		lire_case(r, l2, c2);
+		if ((r->occupes & BIT(l2, c2)) && (pas + 1 < r->chiffre || !(r->adverses & BIT(l2, c2)))){
+			continue;
+		}
+		chemin[pas] = d;
+		int refus_moteur = d == S && l != r->depart / DIMENSION && c != r->depart % DIMENSION;
+		explorer(r, l2, c2, pas + 1, visitees | BIT(l2, c2), rejouable && !refus_moteur, chemin);
+	}
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui remplit m avec les déplacements de la pièce en (l, c), qui doit pouvoir être sélectionnée*/
+static void rechercher(board game, int l, int c, piece_moves * m){
+	direction chemin[NB_DIGITS];
+	recherche r;
+	r.game = game;
+	r.joueur = current_player(game);
+	r.depart = l * DIMENSION + c;
+	r.chiffre = get_digit(game, l, c);
+	r.lues = 0;
+	r.occupes = 0;
+	r.adverses = 0;
+	r.resultat = m;
+	m->reachable = 0;
+	m->replayable = 0;
+	m->nb_steps = r.chiffre;
+	explorer(&r, l, c, 0, BIT(l, c), 1, chemin);
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui indique si un déplacement pièce par pièce est en cours (pièce sélectionnée ou étapes jouées) :
+  board.h n'a pas d'accesseur, on essaie donc cancel_move() sur une copie. Appelée seulement quand la pièce
+  ne peut pas être sélectionnée, elle ne coûte rien aux demandes qui aboutissent.*/
+static int deplacement_en_cours(board game){
+	board copie = copy_game(game);
+	int en_cours = cancel_move(copie) == OK;
+	destroy_game(copie);
+	return en_cours;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+uint64_t get_reachable(board game, int line, int column){
+	piece_moves m;
+	if (!is_legal_move(game, line, column)){
+		return 0;
+	}
+	rechercher(game, line, column, &m);
+	return m.reachable;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+enum return_code get_moves(board game, int line, int column, piece_moves * out){
+	if (line < 0 || line >= DIMENSION || column < 0 || column >= DIMENSION){
+		return OUT;
+	}
+	if (piece_to_place(game) != NONE){
+		return STAGE;
+	}
+	int a_soi = get_place_holder(game, line, column) == current_player(game);
+	if (!a_soi || !is_legal_move(game, line, column)){
+		if (deplacement_en_cours(game)){
+			return STAGE;
+		}
+		return a_soi ? RULES : BUSY;
+	}
+	rechercher(game, line, column, out);
+	return OK;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+enum return_code get_move_path(board game, int start_line, int start_column,
+		int target_line, int target_column, direction * out, bool * replayable){
+	piece_moves m;
+	if (target_line < 0 || target_line >= DIMENSION || target_column < 0 || target_column >= DIMENSION){
+		return OUT;
+	}
+	enum return_code code = get_moves(game, start_line, start_column, &m);
+	if (code != OK){
+		return code;
+	}
+	if (!(m.reachable & BIT(target_line, target_column))){
+		return RULES;
+	}
+	for (int i = 0; i < m.nb_steps; i++){
+		out[i] = m.paths[target_line * DIMENSION + target_column][i];
+	}
+	if (replayable != NULL){
+		*replayable = (m.replayable & BIT(target_line, target_column)) != 0;
+	}
+	return OK;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
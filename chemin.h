@@ -0,0 +1,48 @@
+#ifndef _CHEMIN_H_
+#define _CHEMIN_H_
+
+#include <stdint.h>
+#include "board.h"
+
+/*Recherche des déplacements possibles d'une pièce, construite sur les fonctions de board.h.
+  Les cases sont représentées par des bits : la case (l, c) est le bit l * DIMENSION + c,
+  un plateau de 6 x 6 tient donc dans un entier de 64 bits.
+  Il n'y a pas de cache : chaque appel refait la recherche et ne lit que les cases que la pièce peut traverser.
+  Son coût vient surtout de is_legal_move() et de ces lectures dans board.o ; dans bench, il est
+  d'environ la moitié d'un copy_game() suivi d'un quick_move(). Pour interroger plusieurs cibles
+  d'une même pièce, get_moves() renvoie en un seul appel les cases atteignables et tous les chemins.*/
+
+/*Déplacements possibles d'une pièce*/
+typedef struct {
+	uint64_t reachable; /*cases où la pièce peut terminer son déplacement*/
+	uint64_t replayable; /*cases atteignables dont le chemin est accepté par move_one_step()*/
+	int nb_steps; /*nombre d'étapes de chaque chemin, le chiffre de la case de départ*/
+	direction paths[DIMENSION * DIMENSION][NB_DIGITS]; /*un chemin pour chaque case atteignable*/
+} piece_moves;
+
+/*Renvoie le masque des cases où la pièce en (line, column) peut terminer son déplacement.
+  Le masque est vide si la pièce ne peut pas être sélectionnée (voir is_legal_move())*/
+uint64_t get_reachable(board game, int line, int column);
+
+/*Remplit out avec tous les déplacements de la pièce en (line, column) : cases atteignables et,
+  pour chacune, une suite de out->nb_steps directions qui l'atteint avec move_one_step().
+  Les codes de retour sont ceux de quick_move(), dans le même ordre :
+  * ::OUT si la case n'est pas sur la grille,
+  * ::STAGE pendant le set-up, ou si une pièce est déjà sélectionnée ou en cours de déplacement,
+  * ::BUSY si la case ne contient pas une pièce du joueur courant,
+  * ::RULES si la pièce ne peut pas être sélectionnée.
+  Les chemins sont choisis parmi ceux que move_one_step() de board.o accepte (voir chemin.c), mais pour
+  environ 5 % des cibles atteignables aucun ne convient : le chemin respecte alors les règles et seul
+  quick_move() le jouera. Ces cibles sont celles de reachable absentes de replayable.*/
+enum return_code get_moves(board game, int line, int column, piece_moves * out);
+
+/*Écrit dans out une suite de get_digit(game, start_line, start_column) directions qui amène,
+  avec move_one_step(), la pièce en (start_line, start_column) en (target_line, target_column).
+  Les codes de retour sont ceux de get_moves(), ::OUT couvrant aussi la cible, et ::RULES
+  si la pièce ne peut pas atteindre la cible. out doit pouvoir contenir ::NB_DIGITS directions.
+  Si replayable n'est pas NULL, *replayable indique après ::OK si le chemin peut être rejoué
+  étape par étape avec select_piece() et move_one_step().*/
+enum return_code get_move_path(board game, int start_line, int start_column,
+	int target_line, int target_column, direction * out, bool * replayable);
+
+#endif /*_CHEMIN_H_*/
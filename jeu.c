@@ -4,13 +4,32 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "board.h"
+#include "chemin.h"
 #include <ctype.h>
+#include <time.h>
+#include <string.h>
 #define RED "\033[31m"
 #define BLUE "\033[34m"
 #define WHITE "\033[37m"
+#define NB_DISPOSITIONS_EQUITABLES 10
 //-------------------------------------------------------------------------------------------------------------//
 static char plateau[DIMENSION][DIMENSION];
 //-------------------------------------------------------------------------------------------------------------//
+/*Historique de la partie : le plateau juste après le set-up et le journal des coups joués depuis.
+  Un coup ne tient que sur quelques octets, revenir au coup N consiste à rejouer les N premiers
+  coups du journal sur une copie du plateau de départ. Les coups au-delà de la position courante
+  sont conservés pour redo, jusqu'à ce qu'un nouveau coup soit joué.*/
+typedef struct {
+	char type; /*'D' pour un déplacement, 'I' pour une réintroduction*/
+	char l1, c1, l2, c2;
+} coup;
+
+static board depart = NULL;
+static coup * journal = NULL;
+static int capacite_journal = 0;
+static int nb_coups = 0;
+static int position = 0;
+//-------------------------------------------------------------------------------------------------------------//
 /*Fonction qui permet de vérifier sur le pion est un roi ou un simple pion*/
 char * get_pion(board game , int l , int c){
 		if (is_king(game , l , c) == 1){
@@ -57,6 +76,21 @@ void afficheplateau(board game){
 }
 //-------------------------------------------------------------------------------------------------------------//
 //-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui affiche les cases où le pion en (l, c) peut terminer son déplacement*/
+void afficher_atteignables(board game, int l, int c){
+	uint64_t atteignables = get_reachable(game, l, c);
+	printf("Cases atteignables (colonne, ligne) :");
+	for (int l1 = 0; l1 < DIMENSION; l1++){
+		for (int c1 = 0; c1 < DIMENSION; c1++){
+			if (atteignables & ((uint64_t)1 << (l1 * DIMENSION + c1))){
+				printf(" (%d, %d)", c1, l1);
+			}
+		}
+	}
+	printf("\n");
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
 /*Fonction qui permet de placer les pions de chaque joueur avant le début de la partie*/
 void setup_pions(board game){
 	int c;
@@ -115,18 +149,97 @@ char * affichage_player(board game , int player){
 } 
 //-------------------------------------------------------------------------------------------------------------//
 //-------------------------------------------------------------------------------------------------------------//
-/*Fonction qui permet de déplacer une fois un pion pour le joueur NORTH puis pour le joueur SOUTH*/
-void deplacer(board game){
+/*Fonction qui ajoute un coup au journal à la position courante (les coups annulés sont oubliés)*/
+void enregistrer(char type, int l1, int c1, int l2, int c2){
+	if (position == capacite_journal){
+		capacite_journal = capacite_journal == 0 ? 64 : 2 * capacite_journal;
+		journal = realloc(journal, capacite_journal * sizeof(coup));
+	}
+	journal[position].type = type;
+	journal[position].l1 = l1;
+	journal[position].c1 = c1;
+	journal[position].l2 = l2;
+	journal[position].c2 = c2;
+	position++;
+	nb_coups = position;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui ramène la partie au coup n (0 étant la fin du set-up) et renvoie le nouveau plateau*/
+board aller_au_coup(board game, int n){
+	if (n < 0 || n > nb_coups){
+		printf("Le coup %d n'existe pas (coups joués : %d)\n", n, nb_coups);
+		return game;
+	}
+	destroy_game(game);
+	game = copy_game(depart);
+	for (int i = 0; i < n; i++){
+		if (journal[i].type == 'D'){
+			quick_move(game, journal[i].l1, journal[i].c1, journal[i].l2, journal[i].c2);
+		}
+		else {
+			insert_pawn(game, journal[i].l1, journal[i].c1);
+		}
+	}
+	position = n;
+	printf("Retour au coup %d sur %d\n", position, nb_coups);
+	afficheplateau(game);
+	return game;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui lit soit un nombre (renvoie 1 et le range dans valeur),
+  soit une commande d'historique undo, redo ou goto N (renvoie 0 et range dans valeur le coup visé).
+  Tout autre mot est signalé et la question invite est reposée*/
+int lire_nombre_ou_commande(int * valeur, char * invite){
+	char mot[16];
+	char numero[16];
+	while (1){
+		if (scanf("%15s", mot) != 1){
+			exit(0);
+		}
+		if (sscanf(mot, "%d", valeur) == 1){
+			return 1;
+		}
+		if (strcmp(mot, "undo") == 0){
+			*valeur = position - 1;
+			return 0;
+		}
+		if (strcmp(mot, "redo") == 0){
+			*valeur = position + 1;
+			return 0;
+		}
+		if (strcmp(mot, "goto") == 0){
+			if (scanf("%15s", numero) != 1){
+				exit(0);
+			}
+			if (sscanf(numero, "%d", valeur) == 1){
+				return 0;
+			}
+			printf("goto attend un numéro de coup, pas %s\n", numero);
+		}
+		else {
+			printf("Commande inconnue : %s\n", mot);
+		}
+		printf("%s", invite);
+	}
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui permet de déplacer une fois un pion pour le joueur NORTH puis pour le joueur SOUTH.
+  Renvoie le plateau, qui est remplacé si le joueur a utilisé undo, redo ou goto*/
+board deplacer(board game){
 	int l1;
 	int c1;
 	int l;
 	int c;
 	printf("C'est au joueur %s de déplacer un pion" , affichage_player(game, current_player(game)));
 	printf("\n");
-	printf("Entrez la colonne du pion que vous souhaitez bouger\n");
-	while (scanf("%d" , &c) == 0){
-		getchar();
-		}
+	char * invite = "Entrez la colonne du pion que vous souhaitez bouger (ou undo, redo, goto N)\n";
+	printf("%s", invite);
+	if (!lire_nombre_ou_commande(&c, invite)){
+		return aller_au_coup(game, c);
+	}
 	printf("Entrez la ligne du pion que vous souhaitez bouger\n");
 	while (scanf("%d" , &l) == 0){
 		getchar();
@@ -144,6 +257,7 @@ void deplacer(board game){
 			getchar();
 		}
 	}
+		afficher_atteignables(game, l, c);
 		printf("Entrez la colonne ou vous souhaitez vous déplacer\n");
 		while (scanf("%d" , &c1) == 0){
 		getchar();
@@ -165,10 +279,12 @@ void deplacer(board game){
 						getchar();
 					}
 			}
+		enregistrer('D', l, c, l1, c1);
 		printf("La pièce a été bougée");
 		printf("\n");
 		afficheplateau(game);
 		printf("C'est au joueur %s de déplacer un pion\n" , affichage_player(game, current_player(game)));
+		return game;
 }
 //-------------------------------------------------------------------------------------------------------------//
 //-------------------------------------------------------------------------------------------------------------//
@@ -229,6 +345,39 @@ int can_play2(board game){
 }
 //-------------------------------------------------------------------------------------------------------------//
 //-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui indique si le joueur courant, bloqué, doit réintroduire un pion*/
+int doit_reintroduire(board game){
+	return !(can_play(game) && can_play2(game)) && get_nb_pieces_on_board(game, current_player(game)) < 6;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui demande au joueur courant de réintroduire un pion, ou d'utiliser undo, redo ou goto N.
+  Renvoie le plateau, qui est remplacé si le joueur a utilisé l'historique ; il est inchangé si le pion
+  n'a pas pu être placé, et la question est alors reposée par l'appelant*/
+board reintroduire(board game){
+	int c;
+	int l;
+	char * invite = "Entrez la colonne (ou undo, redo, goto N)\n";
+	printf("Joueur %s : Chosissez les cordonnées du pion à placer \n" , affichage_player(game, current_player(game)));
+	printf("%s", invite);
+	if (!lire_nombre_ou_commande(&c, invite)){
+		return aller_au_coup(game, c);
+	}
+	printf("\n");
+	printf("Entrez la ligne\n");
+	while (scanf("%d" , &l) == 0){
+			getchar();
+	}
+	if (insert_pawn(game, l, c) != OK){
+		printf("Le Pion ne peut pas être placé.\n");
+		return game;
+	}
+	enregistrer('I', l, c, 0, 0);
+	printf("Le Pion du joueur %s a été placé\n" , affichage_player(game, current_player(game)));
+	return game;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
 /*Fonction qui permet de lancer la partie*/
 void start_game(board game){
 	printf("\n");
@@ -238,6 +387,7 @@ void start_game(board game){
 	printf("\n");
 	afficheplateau(game);
 	setup_pions(game);
+	depart = copy_game(game);
 	afficheplateau(game);
 	printf("==============================================================\n");
 	printf("========================|PHASE DE JEU|========================\n");
@@ -245,36 +395,12 @@ void start_game(board game){
 	printf("\n");
 	afficheplateau(game);
 	while (get_winner(game) == NO_PLAYER){
-			deplacer(game);
+			game = deplacer(game);
 			afficheplateau(game);
-			if (!(can_play(game) && (can_play2(game)))){
-			if (get_nb_pieces_on_board(game, current_player(game)) <6){
-				int c;
-				int l;
-				printf("Joueur %s : Chosissez les cordonnées du pion à placer \n" , affichage_player(game, current_player(game)));
-				printf("Entrez la colonne\n");
-				while (scanf("%d" , &c) == 0){
-						getchar();
-				}
-				printf("\n");
-				printf("Entrez la ligne\n");
-				while (scanf("%d" , &l) == 0){
-						getchar();
-				}
-				while (insert_pawn(game, l, c) != OK){
-					printf("Le Pion ne peut pas être placé.\n");	
-					printf("Joueur %s : Chosissez les cordonnées du pion à placer \n" , affichage_player(game, current_player(game)));
-					printf("Entrez la colonne\n");
-					while (scanf("%d" , &c) == 0){
-						getchar();
-					}
-					printf("\n");
-					printf("Entrez la ligne\n");
-					scanf("%d" , &l);	
-				}
-				printf("Le Pion du joueur %s a été placé" , affichage_player(game, current_player(game)));
+			/*undo, redo ou goto peuvent aussi mener à une position où une réintroduction est due*/
+			while (get_winner(game) == NO_PLAYER && doit_reintroduire(game)){
+				game = reintroduire(game);
 			}
-		}
 	}
 	if (get_winner(game) == 1){
 		printf("========================|BRAVO AU JOUEUR \033[31m%s \033[37mQUI GAGNE LA PARTIE !!|========================\n", affichage_player(game, get_winner(game)));
@@ -287,9 +413,43 @@ void start_game(board game){
 }
 //-------------------------------------------------------------------------------------------------------------//
 //-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui crée un plateau à partir de la table écrite par recensement :
+  une des dispositions les plus équitables (en tête de table) est tirée au hasard,
+  puis sa graine est redonnée à rand() pour que new_random_game la reproduise*/
+board partie_equitable(char * fichier){
+	unsigned int graines[NB_DISPOSITIONS_EQUITABLES];
+	unsigned int graine;
+	int nb = 0;
+	char ligne[128];
+	FILE * table = fopen(fichier, "r");
+	if (table == NULL){
+		printf("Impossible d'ouvrir %s, le plateau sera aléatoire\n", fichier);
+		return new_random_game();
+	}
+	while (nb < NB_DISPOSITIONS_EQUITABLES && fgets(ligne, sizeof ligne, table) != NULL){
+		if (sscanf(ligne, "%u", &graine) == 1){
+			graines[nb++] = graine;
+		}
+	}
+	fclose(table);
+	if (nb == 0){
+		return new_random_game();
+	}
+	srand(time(NULL));
+	srand(graines[rand() % nb]);
+	return new_random_game();
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
 //Programme:
-int main(){
-	board game = new_random_game();
+int main(int argc, char ** argv){
+	board game;
+	if (argc > 1){
+		game = partie_equitable(argv[1]);
+	}
+	else {
+		game = new_random_game();
+	}
 	start_game(game);
 }
 //-------------------------------------------------------------------------------------------------------------//
@@ -0,0 +1,209 @@
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+//Bibliothèques:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "board.h"
+#include "autojeu.h"
+#define NB_CASES (DIMENSION * DIMENSION)
+#define MAX_COUPS 200
+#define NB_FINALISTES 20
+#define FACTEUR_FINALE 10
+//-------------------------------------------------------------------------------------------------------------//
+/*Recensement des dispositions de chiffres produites par new_random_game.
+  random_lines ne tire ses chiffres qu'avec rand() : une disposition est donc entièrement
+  déterminée par la graine passée à srand() avant new_random_game. Le programme tire des graines,
+  élimine les dispositions identiques à la symétrie gauche/droite près, fait jouer à chaque
+  disposition un nombre fixe de parties aléatoires sur plusieurs threads, puis écrit la table
+  des dispositions triée de la plus équitable à la moins équitable.
+
+  L'écart |N - S| entre victoires de NORTH et de SOUTH est normalisé par son écart-type sous
+  l'hypothèse d'une disposition équitable, sqrt(N + S) : sur quelques dizaines de parties, un écart
+  brut de quelques victoires n'est que du bruit. Les NB_FINALISTES meilleures dispositions jouent
+  ensuite FACTEUR_FINALE fois plus de parties au total et sont reclassées en tête de table.
+
+  La symétrie haut/bas n'est pas utilisée : elle échange les rôles de NORTH et SOUTH,
+  or NORTH joue toujours en premier.*/
+//-------------------------------------------------------------------------------------------------------------//
+typedef struct {
+	char chiffres[NB_CASES + 1]; /*forme canonique de la disposition*/
+	unsigned int graine; /*plus petite graine qui produit la disposition*/
+	board modele;
+	int victoires_nord;
+	int victoires_sud;
+	int nulles;
+	int parties_jouees;
+} disposition;
+
+static disposition * dispositions;
+static int nb_dispositions;
+static int parties_par_disposition;
+static int nb_a_evaluer; /*les dispositions 0 à nb_a_evaluer - 1 sont évaluées par les threads*/
+static int parties_a_jouer; /*nombre de parties supplémentaires pour chacune*/
+static int prochaine = 0;
+static pthread_mutex_t verrou = PTHREAD_MUTEX_INITIALIZER;
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui écrit dans chiffres la forme canonique de la disposition du plateau :
+  la plus petite (ordre lexicographique) entre la disposition et son miroir gauche/droite*/
+void forme_canonique(board game, char * chiffres){
+	char miroir[NB_CASES + 1];
+	for (int l = 0; l < DIMENSION; l++){
+		for (int c = 0; c < DIMENSION; c++){
+			chiffres[l * DIMENSION + c] = '0' + get_digit(game, l, c);
+			miroir[l * DIMENSION + DIMENSION - 1 - c] = '0' + get_digit(game, l, c);
+		}
+	}
+	chiffres[NB_CASES] = '\0';
+	miroir[NB_CASES] = '\0';
+	if (strcmp(miroir, chiffres) < 0){
+		strcpy(chiffres, miroir);
+	}
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+int comparer_chiffres(const void * a, const void * b){
+	const disposition * d1 = a;
+	const disposition * d2 = b;
+	int cmp = strcmp(d1->chiffres, d2->chiffres);
+	if (cmp != 0){
+		return cmp;
+	}
+	return (d1->graine > d2->graine) - (d1->graine < d2->graine);
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui renvoie l'écart normalisé |N - S| / sqrt(N + S) des victoires de la disposition*/
+double ecart_normalise(const disposition * d){
+	int decidees = d->victoires_nord + d->victoires_sud;
+	if (decidees == 0){
+		return 0;
+	}
+	return abs(d->victoires_nord - d->victoires_sud) / sqrt(decidees);
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Tri de la table : les dispositions les plus jouées (finalistes) d'abord, puis le plus petit écart normalisé*/
+int comparer_equite(const void * a, const void * b){
+	const disposition * d1 = a;
+	const disposition * d2 = b;
+	if (d1->parties_jouees != d2->parties_jouees){
+		return d2->parties_jouees - d1->parties_jouees;
+	}
+	double ecart1 = ecart_normalise(d1);
+	double ecart2 = ecart_normalise(d2);
+	if (ecart1 != ecart2){
+		return (ecart1 > ecart2) - (ecart1 < ecart2);
+	}
+	return (d1->graine > d2->graine) - (d1->graine < d2->graine);
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui tire nb_tirages graines et ne garde qu'une graine par disposition canonique*/
+void tirer_dispositions(int nb_tirages){
+	dispositions = malloc(nb_tirages * sizeof(disposition));
+	for (int i = 0; i < nb_tirages; i++){
+		dispositions[i].graine = i + 1;
+		srand(dispositions[i].graine);
+		dispositions[i].modele = new_random_game();
+		forme_canonique(dispositions[i].modele, dispositions[i].chiffres);
+		dispositions[i].victoires_nord = 0;
+		dispositions[i].victoires_sud = 0;
+		dispositions[i].nulles = 0;
+		dispositions[i].parties_jouees = 0;
+	}
+	qsort(dispositions, nb_tirages, sizeof(disposition), comparer_chiffres);
+	nb_dispositions = 0;
+	for (int i = 0; i < nb_tirages; i++){
+		if (nb_dispositions > 0 && strcmp(dispositions[nb_dispositions - 1].chiffres, dispositions[i].chiffres) == 0){
+			destroy_game(dispositions[i].modele);
+		}
+		else {
+			dispositions[nb_dispositions++] = dispositions[i];
+		}
+	}
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction exécutée par chaque thread : tant qu'il reste des dispositions à évaluer, le thread
+  prend la suivante et lui fait jouer parties_a_jouer parties de plus. Un thread qui finit tôt reprend donc
+  du travail aux autres plutôt que d'attendre.*/
+void * evaluer(void * inutilise){
+	(void)inutilise;
+	while (1){
+		pthread_mutex_lock(&verrou);
+		int i = prochaine++;
+		pthread_mutex_unlock(&verrou);
+		if (i >= nb_a_evaluer){
+			return NULL;
+		}
+		disposition * d = &dispositions[i];
+		for (int partie = 0; partie < parties_a_jouer; partie++){
+			/*Les graines continuent d'une passe à l'autre : aucune partie n'est rejouée*/
+			unsigned int graine = d->graine * 7919u + d->parties_jouees++;
+			board game = copy_game(d->modele);
+			placer_aleatoirement(game, &graine);
+			switch(jouer_partie_aleatoire(game, MAX_COUPS, &graine)){
+				case NORTH : d->victoires_nord++;
+				break;
+				case SOUTH : d->victoires_sud++;
+				break;
+				default : d->nulles++;
+				break;
+			}
+			destroy_game(game);
+		}
+	}
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+//Programme:
+int main(int argc, char ** argv){
+	int nb_tirages = argc > 1 ? atoi(argv[1]) : 1000;
+	parties_par_disposition = argc > 2 ? atoi(argv[2]) : 50;
+	int nb_threads = argc > 3 ? atoi(argv[3]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+	char * fichier = argc > 4 ? argv[4] : "dispositions.txt";
+	if (nb_tirages <= 0 || parties_par_disposition <= 0 || nb_threads <= 0){
+		fprintf(stderr, "Utilisation : %s [nb_tirages] [parties_par_disposition] [nb_threads] [fichier]\n", argv[0]);
+		return 1;
+	}
+	tirer_dispositions(nb_tirages);
+	printf("%d dispositions différentes pour %d graines tirées\n", nb_dispositions, nb_tirages);
+	pthread_t * threads = malloc(nb_threads * sizeof(pthread_t));
+	/*Première passe sur toutes les dispositions, seconde passe sur les finalistes*/
+	for (int passe = 0; passe < 2; passe++){
+		nb_a_evaluer = passe == 0 ? nb_dispositions : (nb_dispositions < NB_FINALISTES ? nb_dispositions : NB_FINALISTES);
+		parties_a_jouer = passe == 0 ? parties_par_disposition : (FACTEUR_FINALE - 1) * parties_par_disposition;
+		prochaine = 0;
+		for (int t = 0; t < nb_threads; t++){
+			pthread_create(&threads[t], NULL, evaluer, NULL);
+		}
+		for (int t = 0; t < nb_threads; t++){
+			pthread_join(threads[t], NULL);
+		}
+		qsort(dispositions, nb_dispositions, sizeof(disposition), comparer_equite);
+	}
+	free(threads);
+	FILE * sortie = fopen(fichier, "w");
+	if (sortie == NULL){
+		fprintf(stderr, "Impossible d'écrire %s\n", fichier);
+		return 1;
+	}
+	fprintf(sortie, "# graine victoires_nord victoires_sud nulles ecart_normalise chiffres\n");
+	for (int i = 0; i < nb_dispositions; i++){
+		disposition * d = &dispositions[i];
+		fprintf(sortie, "%u %d %d %d %.3f %s\n", d->graine, d->victoires_nord, d->victoires_sud, d->nulles,
+			ecart_normalise(d), d->chiffres);
+		destroy_game(d->modele);
+	}
+	fclose(sortie);
+	free(dispositions);
+	printf("Table écrite dans %s\n", fichier);
+	return 0;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
@@ -0,0 +1,424 @@
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+//Bibliothèques:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "board.h"
+#include "autojeu.h"
+#define TAILLE_LIGNE 256
+#define TAILLE_TRACE 512
+#define TAILLE_LECTURE 65536
+#define MAX_COUPS 200
+//-------------------------------------------------------------------------------------------------------------//
+/*Programme de rejeu : exécute un script d'appels au moteur (board.o) et affiche, après chaque appel,
+  le code de retour et tout ce que les accesseurs de board.h permettent d'observer.
+  La trace obtenue est déterministe : deux versions du moteur se comparent en diffant leurs traces.
+  Avec -m, le programme réduit un script qui fait diverger deux exécutables rejeu (liés à deux board.o
+  différents) en retirant des lignes tant que les traces des deux exécutables restent différentes.
+  Avec -g, le programme écrit un corpus de parties aléatoires (autojeu) sous forme de scripts.
+
+  Format du script (une commande par ligne, '#' pour les commentaires) :
+	seed N             (facultatif, en première ligne : plateau de srand(N) puis new_random_game,
+	                    sinon le plateau périodique de new_game)
+	place l c
+	select l c
+	step N|S|E|W
+	cancel
+	insert l c
+	quick l1 c1 l2 c2
+*/
+//-------------------------------------------------------------------------------------------------------------//
+static const char * noms_retour[] = {"OK", "OUT", "BUSY", "RULES", "STAGE"};
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui écrit dans trace l'état observable du plateau après un appel ayant renvoyé ret (un code valide)*/
+void observer(board game, int ret, char * trace){
+	int n = 0;
+	n += sprintf(trace + n, "%s joueur=%d prescrit=%d gagnant=%d pieces=%d/%d a_placer=%d grille=",
+		noms_retour[ret], current_player(game), get_prescribed_move(game), get_winner(game),
+		get_nb_pieces_on_board(game, NORTH), get_nb_pieces_on_board(game, SOUTH), piece_to_place(game));
+	for (int l = 0; l < DIMENSION; l++){
+		for (int c = 0; c < DIMENSION; c++){
+			switch(get_place_holder(game, l, c)){
+				case NORTH : trace[n++] = is_king(game, l, c) ? 'N' : 'n';
+				break;
+				case SOUTH : trace[n++] = is_king(game, l, c) ? 'S' : 's';
+				break;
+				default : trace[n++] = '.';
+				break;
+			}
+		}
+	}
+	n += sprintf(trace + n, " legal=");
+	for (int l = 0; l < DIMENSION; l++){
+		for (int c = 0; c < DIMENSION; c++){
+			trace[n++] = is_legal_move(game, l, c) ? '1' : '0';
+		}
+	}
+	trace[n] = '\0';
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui exécute une ligne du script, renvoie le code de retour du moteur ou -1 si la ligne est invalide*/
+int executer(board game, char * ligne){
+	char commande[16];
+	char dir;
+	int a, b, x, y;
+	if (sscanf(ligne, "%15s", commande) != 1){
+		return -1;
+	}
+	if (strcmp(commande, "place") == 0 && sscanf(ligne, "%*s %d %d", &a, &b) == 2){
+		return place_piece(game, a, b);
+	}
+	if (strcmp(commande, "select") == 0 && sscanf(ligne, "%*s %d %d", &a, &b) == 2){
+		return select_piece(game, a, b);
+	}
+	if (strcmp(commande, "insert") == 0 && sscanf(ligne, "%*s %d %d", &a, &b) == 2){
+		return insert_pawn(game, a, b);
+	}
+	if (strcmp(commande, "quick") == 0 && sscanf(ligne, "%*s %d %d %d %d", &a, &b, &x, &y) == 4){
+		return quick_move(game, a, b, x, y);
+	}
+	if (strcmp(commande, "cancel") == 0){
+		return cancel_move(game);
+	}
+	if (strcmp(commande, "step") == 0 && sscanf(ligne, "%*s %c", &dir) == 1){
+		switch(dir){
+			case 'N' : return move_one_step(game, N);
+			case 'S' : return move_one_step(game, S);
+			case 'E' : return move_one_step(game, E);
+			case 'W' : return move_one_step(game, W);
+		}
+	}
+	return -1;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui indique si une ligne du script est vide ou un commentaire*/
+int ligne_ignoree(char * ligne){
+	while (*ligne == ' ' || *ligne == '\t'){
+		ligne++;
+	}
+	return *ligne == '\0' || *ligne == '\n' || *ligne == '#';
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui lit dans ligne la prochaine commande du script (lignes vides et commentaires sautés).
+  Renvoie 0 à la fin du script*/
+int lire_commande(FILE * script, char * ligne){
+	do {
+		if (fgets(ligne, TAILLE_LIGNE, script) == NULL){
+			return 0;
+		}
+	} while (ligne_ignoree(ligne));
+	return 1;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui ajoute la ligne au texte du script déjà exécuté, terminée par un retour à la ligne*/
+void ajouter_ligne(char ** prefixe, size_t * taille_prefixe, char * ligne){
+	size_t longueur = strlen(ligne);
+	*prefixe = realloc(*prefixe, *taille_prefixe + longueur + 2);
+	strcpy(*prefixe + *taille_prefixe, ligne);
+	*taille_prefixe += longueur;
+	if (ligne[longueur - 1] != '\n'){
+		(*prefixe)[(*taille_prefixe)++] = '\n';
+		(*prefixe)[*taille_prefixe] = '\0';
+	}
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui rejoue le script sur le plateau de son en-tête seed N, ou à défaut sur le plateau
+  périodique de new_game, et affiche la trace.
+  Si reference n'est pas NULL, la trace est comparée ligne à ligne à celle du fichier :
+  à la première divergence, le script jusqu'à l'appel divergent est affiché (voir -m pour le réduire).
+  Renvoie 0 si tout s'est bien passé, 1 en cas de divergence, 2 en cas d'erreur.*/
+int rejouer(FILE * script, FILE * reference){
+	char ligne[TAILLE_LIGNE];
+	char trace[TAILLE_TRACE];
+	char attendue[TAILLE_TRACE];
+	char * prefixe = NULL;
+	size_t taille_prefixe = 0;
+	int appel = 0;
+	int statut = 0;
+	unsigned int graine;
+	board game;
+	int en_attente = lire_commande(script, ligne); /*ligne lue mais pas encore exécutée*/
+	if (en_attente && sscanf(ligne, " seed %u", &graine) == 1){
+		srand(graine);
+		game = new_random_game();
+		ajouter_ligne(&prefixe, &taille_prefixe, ligne);
+		en_attente = 0;
+	}
+	else {
+		game = new_game();
+	}
+	/*Les chiffres du plateau font partie de l'état observable : ils sont tracés une seule fois*/
+	int n = sprintf(trace, "chiffres=");
+	for (int l = 0; l < DIMENSION; l++){
+		for (int c = 0; c < DIMENSION; c++){
+			trace[n++] = '0' + get_digit(game, l, c);
+		}
+	}
+	trace[n] = '\0';
+	while (statut == 0){
+		if (reference == NULL){
+			printf("%s\n", trace);
+		}
+		else {
+			if (fgets(attendue, sizeof attendue, reference) == NULL){
+				strcpy(attendue, "(fin de trace)\n");
+			}
+			if (strcspn(attendue, "\n") != strlen(trace) || strncmp(attendue, trace, strlen(trace)) != 0){
+				printf("Divergence à l'appel %d\n", appel);
+				printf("attendu : %s", attendue);
+				printf("obtenu  : %s\n", trace);
+				printf("Script jusqu'à la divergence :\n%s", prefixe == NULL ? "" : prefixe);
+				statut = 1;
+				break;
+			}
+		}
+		if (!en_attente && !lire_commande(script, ligne)){
+			if (reference != NULL && fgets(attendue, sizeof attendue, reference) != NULL){
+				printf("Divergence après l'appel %d : la trace de référence continue\n", appel);
+				printf("attendu : %s", attendue);
+				statut = 1;
+			}
+			free(prefixe);
+			destroy_game(game);
+			return statut;
+		}
+		en_attente = 0;
+		int ret = executer(game, ligne);
+		if (ret < 0){
+			fprintf(stderr, "Commande invalide : %s", ligne);
+			statut = 2;
+			break;
+		}
+		appel++;
+		ajouter_ligne(&prefixe, &taille_prefixe, ligne);
+		n = sprintf(trace, "%d %.*s ", appel, (int)strcspn(ligne, "\n"), ligne);
+		observer(game, ret, trace + n);
+	}
+	free(prefixe);
+	destroy_game(game);
+	return statut;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui exécute "programme fichier" et renvoie sa sortie suivie de son code de sortie (chaîne à libérer)*/
+char * sortie_de(char * programme, char * fichier){
+	int tube[2];
+	if (pipe(tube) < 0){
+		return NULL;
+	}
+	pid_t pid = fork();
+	if (pid == 0){
+		dup2(tube[1], STDOUT_FILENO);
+		close(tube[0]);
+		close(tube[1]);
+		execl(programme, programme, fichier, (char *)NULL);
+		_exit(127);
+	}
+	close(tube[1]);
+	size_t taille = 0;
+	size_t capacite = TAILLE_LECTURE;
+	char * sortie = malloc(capacite);
+	ssize_t lus;
+	while ((lus = read(tube[0], sortie + taille, capacite - taille - 32)) > 0){
+		taille += lus;
+		if (capacite - taille < TAILLE_LECTURE){
+			capacite *= 2;
+			sortie = realloc(sortie, capacite);
+		}
+	}
+	close(tube[0]);
+	int statut = 0;
+	waitpid(pid, &statut, 0);
+	sprintf(sortie + taille, "statut=%d\n", WIFEXITED(statut) ? WEXITSTATUS(statut) : -1);
+	return sortie;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui écrit dans fichier les lignes gardées du script et indique si les deux exécutables
+  produisent des traces différentes sur ce script*/
+int divergent(char * rejeu_a, char * rejeu_b, char * fichier, char ** lignes, int * gardees, int nb){
+	FILE * candidat = fopen(fichier, "w");
+	if (candidat == NULL){
+		return 0;
+	}
+	for (int i = 0; i < nb; i++){
+		if (gardees[i]){
+			fputs(lignes[i], candidat);
+		}
+	}
+	fclose(candidat);
+	char * trace_a = sortie_de(rejeu_a, fichier);
+	char * trace_b = sortie_de(rejeu_b, fichier);
+	int resultat = trace_a != NULL && trace_b != NULL && strcmp(trace_a, trace_b) != 0;
+	free(trace_a);
+	free(trace_b);
+	return resultat;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui réduit le script en retirant des blocs de lignes de plus en plus petits (façon ddmin) :
+  un bloc est retiré pour de bon si les deux exécutables divergent encore sans lui.
+  L'en-tête seed N est toujours gardé : sans lui, le script porterait sur un autre plateau.
+  Les passes ligne par ligne sont répétées jusqu'à ce qu'aucune ligne ne puisse plus être retirée.
+  Affiche le script réduit, renvoie 1 s'il y a divergence, 0 sinon, 2 en cas d'erreur.*/
+int minimiser(char * rejeu_a, char * rejeu_b, FILE * script){
+	char ligne[TAILLE_LIGNE];
+	char ** lignes = NULL;
+	int nb = 0;
+	while (fgets(ligne, sizeof ligne, script) != NULL){
+		if (!ligne_ignoree(ligne)){
+			lignes = realloc(lignes, (nb + 1) * sizeof(char *));
+			lignes[nb] = malloc(strlen(ligne) + 2);
+			strcpy(lignes[nb], ligne);
+			if (ligne[strlen(ligne) - 1] != '\n'){
+				strcat(lignes[nb], "\n");
+			}
+			nb++;
+		}
+	}
+	char fichier[] = "/tmp/rejeu_XXXXXX";
+	int fd = mkstemp(fichier);
+	if (fd < 0){
+		fprintf(stderr, "Impossible de créer un fichier temporaire\n");
+		return 2;
+	}
+	close(fd);
+	unsigned int graine;
+	int entete = nb > 0 && sscanf(lignes[0], " seed %u", &graine) == 1;
+	int * gardees = malloc((nb + 1) * sizeof(int));
+	int * retirees = malloc((nb + 1) * sizeof(int));
+	for (int i = 0; i < nb; i++){
+		gardees[i] = 1;
+	}
+	int statut = divergent(rejeu_a, rejeu_b, fichier, lignes, gardees, nb);
+	if (statut == 0){
+		printf("Aucune divergence entre %s et %s\n", rejeu_a, rejeu_b);
+	}
+	else {
+		int taille = nb / 2 > 0 ? nb / 2 : 1;
+		int retrait = 1;
+		while (taille > 1 || retrait){
+			retrait = 0;
+			for (int debut = 0; debut < nb; debut += taille){
+				int nb_retirees = 0;
+				for (int i = debut; i < nb && i < debut + taille; i++){
+					if (gardees[i] && !(entete && i == 0)){
+						gardees[i] = 0;
+						retirees[nb_retirees++] = i;
+					}
+				}
+				if (nb_retirees == 0){
+					continue;
+				}
+				if (divergent(rejeu_a, rejeu_b, fichier, lignes, gardees, nb)){
+					retrait = 1;
+				}
+				else {
+					for (int i = 0; i < nb_retirees; i++){
+						gardees[retirees[i]] = 1;
+					}
+				}
+			}
+			if (taille > 1){
+				taille /= 2;
+				retrait = 1;
+			}
+		}
+		printf("# Script réduit :\n");
+		for (int i = 0; i < nb; i++){
+			if (gardees[i]){
+				printf("%s", lignes[i]);
+			}
+		}
+	}
+	unlink(fichier);
+	for (int i = 0; i < nb; i++){
+		free(lignes[i]);
+	}
+	free(lignes);
+	free(gardees);
+	free(retirees);
+	return statut;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui écrit nb_parties parties aléatoires dans dossier/partie_N.txt : plateau de la graine N,
+  placement et coups joués par autojeu, chaque appel au moteur étant écrit dans le script*/
+int generer(int nb_parties, char * dossier){
+	char nom[TAILLE_LIGNE];
+	for (int i = 1; i <= nb_parties; i++){
+		snprintf(nom, sizeof nom, "%s/partie_%d.txt", dossier, i);
+		FILE * fichier = fopen(nom, "w");
+		if (fichier == NULL){
+			fprintf(stderr, "Impossible d'écrire %s\n", nom);
+			return 2;
+		}
+		unsigned int graine = i * 7919u;
+		fprintf(fichier, "seed %d\n", i);
+		srand(i);
+		board game = new_random_game();
+		enregistrer_appels(fichier);
+		placer_aleatoirement(game, &graine);
+		jouer_partie_aleatoire(game, MAX_COUPS, &graine);
+		enregistrer_appels(NULL);
+		destroy_game(game);
+		fclose(fichier);
+	}
+	printf("%d partie(s) écrite(s) dans %s\n", nb_parties, dossier);
+	return 0;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+//Programme:
+int main(int argc, char ** argv){
+	if (argc == 4 && strcmp(argv[1], "-g") == 0 && atoi(argv[2]) > 0){
+		return generer(atoi(argv[2]), argv[3]);
+	}
+	if (argc == 5 && strcmp(argv[1], "-m") == 0){
+		FILE * script = fopen(argv[4], "r");
+		if (script == NULL){
+			fprintf(stderr, "Impossible d'ouvrir %s\n", argv[4]);
+			return 2;
+		}
+		int statut = minimiser(argv[2], argv[3], script);
+		fclose(script);
+		return statut;
+	}
+	if (argc < 2 || argc > 3){
+		fprintf(stderr, "Utilisation : %s script [trace_de_reference]\n", argv[0]);
+		fprintf(stderr, "              %s -m rejeu_a rejeu_b script\n", argv[0]);
+		fprintf(stderr, "              %s -g nb_parties dossier\n", argv[0]);
+		return 2;
+	}
+	FILE * script = fopen(argv[1], "r");
+	if (script == NULL){
+		fprintf(stderr, "Impossible d'ouvrir %s\n", argv[1]);
+		return 2;
+	}
+	FILE * reference = NULL;
+	if (argc == 3){
+		reference = fopen(argv[2], "r");
+		if (reference == NULL){
+			fprintf(stderr, "Impossible d'ouvrir %s\n", argv[2]);
+			fclose(script);
+			return 2;
+		}
+	}
+	int statut = rejouer(script, reference);
+	fclose(script);
+	if (reference != NULL){
+		fclose(reference);
+	}
+	return statut;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
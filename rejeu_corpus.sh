@@ -0,0 +1,37 @@
+#!/bin/sh
+# Rejoue en parallèle tous les scripts *.txt d'un dossier avec deux exécutables rejeu
+# (liés à deux board.o différents) et compare leurs traces.
+# Pour chaque script divergent, le script réduit par rejeu -m est écrit dans <script>.min.
+# Un script que l'un des deux exécutables ne peut pas rejouer (statut 2, par exemple une commande
+# invalide) est aussi en échec : son message d'erreur est affiché et il n'est pas réduit.
+# Affiche la liste des scripts en échec et renvoie 1 s'il y en a au moins un.
+# Un corpus de parties aléatoires s'écrit avec : rejeu -g nb_parties dossier
+#
+# Utilisation : ./rejeu_corpus.sh rejeu_a rejeu_b dossier [nb_processus]
+
+if [ $# -lt 3 ]; then
+	echo "Utilisation : $0 rejeu_a rejeu_b dossier [nb_processus]" >&2
+	exit 2
+fi
+REJEU_A=$1
+REJEU_B=$2
+DOSSIER=$3
+NB_PROCESSUS=${4:-$(nproc)}
+
+ECHECS=$(find "$DOSSIER" -name '*.txt' -print0 | xargs -0 -r -P "$NB_PROCESSUS" -I{} sh -c '
+	trace_a=$("$1" "$3"); statut_a=$?
+	trace_b=$("$2" "$3"); statut_b=$?
+	if [ $statut_a -eq 2 ] || [ $statut_b -eq 2 ]; then
+		echo "ERREUR $3 (statuts $statut_a et $statut_b)"
+	elif [ $statut_a -ne $statut_b ] || [ "$trace_a" != "$trace_b" ]; then
+		"$1" -m "$1" "$2" "$3" > "$3.min"
+		echo "ÉCHEC $3"
+	fi' sh "$REJEU_A" "$REJEU_B" {})
+
+NB_SCRIPTS=$(find "$DOSSIER" -name '*.txt' | wc -l)
+if [ -n "$ECHECS" ]; then
+	echo "$ECHECS" | sort -k2
+	echo "$(echo "$ECHECS" | grep -c '^ÉCHEC') script(s) divergent(s) et $(echo "$ECHECS" | grep -c '^ERREUR') script(s) en erreur sur $NB_SCRIPTS"
+	exit 1
+fi
+echo "Aucune divergence sur $NB_SCRIPTS script(s)"
@@ -0,0 +1,333 @@
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+//Bibliothèques:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "board.h"
+#include "autojeu.h"
+#define TAILLE_TAMPON 4096
+#define TAILLE_REPONSE 256
+#define TAILLE_SORTIE 65536
+//-------------------------------------------------------------------------------------------------------------//
+/*Serveur de parties : un seul processus héberge toutes les parties en cours.
+  Une boucle poll() attend les commandes des clients connectés sur une socket locale (Unix),
+  chaque commande est une ligne de texte et reçoit une ligne de réponse :
+	new                      -> OK id        (crée une partie avec new_random_game)
+	place id l c             -> code de retour de place_piece
+	move id l1 c1 l2 c2      -> code de retour de quick_move
+	insert id l c            -> code de retour de insert_pawn
+	ai id                    -> OK si un coup aléatoire a été joué pour le joueur courant
+	state id                 -> OK joueur prescrit gagnant grille
+	stats id                 -> OK coups latence_moyenne_ns latence_max_ns
+	end id                   -> OK (détruit la partie)
+  Toute erreur de syntaxe ou de numéro de partie est signalée par une ligne commençant par ERR.
+
+  Les sockets des clients ne sont pas bloquantes : les réponses s'accumulent dans le tampon de sortie
+  du client et sont envoyées quand poll() signale POLLOUT. Tant que ce tampon est plein, le serveur
+  ne lit plus les commandes de ce client, sans bloquer les autres.
+  SIGTERM ou SIGINT arrêtent proprement le serveur : la socket est supprimée et le processus se termine
+  par exit(), ce qui écrit aussi les profils quand il est compilé pour l'entraînement de make pgo.*/
+//-------------------------------------------------------------------------------------------------------------//
+typedef struct {
+	board game; /*NULL si la partie est terminée*/
+	unsigned int graine; /*graine des coups joués par l'IA*/
+	long nb_coups;
+	long long latence_totale;
+	long long latence_max;
+} partie;
+
+typedef struct {
+	char entree[TAILLE_TAMPON]; /*commandes reçues, pas encore exécutées*/
+	int taille_entree;
+	char sortie[TAILLE_SORTIE]; /*réponses pas encore envoyées*/
+	int taille_sortie;
+} client;
+
+static const char * noms_retour[] = {"OK", "OUT", "BUSY", "RULES", "STAGE"};
+static partie * parties = NULL;
+static int nb_parties = 0;
+static int capacite_parties = 0;
+static volatile sig_atomic_t arret = 0;
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui renvoie l'heure en nanosecondes*/
+long long maintenant(){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui crée une nouvelle partie et renvoie son numéro*/
+int nouvelle_partie(){
+	if (nb_parties == capacite_parties){
+		capacite_parties = capacite_parties == 0 ? 64 : 2 * capacite_parties;
+		parties = realloc(parties, capacite_parties * sizeof(partie));
+	}
+	partie * p = &parties[nb_parties];
+	p->game = new_random_game();
+	p->graine = nb_parties + 1;
+	p->nb_coups = 0;
+	p->latence_totale = 0;
+	p->latence_max = 0;
+	return nb_parties++;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui renvoie la partie de numéro id, ou NULL si elle n'existe pas ou plus*/
+partie * trouver_partie(int id){
+	if (id < 0 || id >= nb_parties || parties[id].game == NULL){
+		return NULL;
+	}
+	return &parties[id];
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui écrit dans reponse l'état de la partie*/
+void decrire_partie(board game, char * reponse){
+	int n = sprintf(reponse, "OK %d %d %d ", current_player(game), get_prescribed_move(game), get_winner(game));
+	for (int l = 0; l < DIMENSION; l++){
+		for (int c = 0; c < DIMENSION; c++){
+			switch(get_place_holder(game, l, c)){
+				case NORTH : reponse[n++] = is_king(game, l, c) ? 'N' : 'n';
+				break;
+				case SOUTH : reponse[n++] = is_king(game, l, c) ? 'S' : 's';
+				break;
+				default : reponse[n++] = '0' + get_digit(game, l, c);
+				break;
+			}
+		}
+	}
+	reponse[n] = '\0';
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui exécute une commande et écrit la réponse (sans retour à la ligne)*/
+void executer_commande(char * ligne, char * reponse){
+	char commande[16];
+	int id, a, b, x, y;
+	int ret = -1;
+	if (sscanf(ligne, "%15s", commande) != 1){
+		strcpy(reponse, "ERR commande vide");
+		return;
+	}
+	if (strcmp(commande, "new") == 0){
+		sprintf(reponse, "OK %d", nouvelle_partie());
+		return;
+	}
+	if (sscanf(ligne, "%*s %d", &id) != 1){
+		strcpy(reponse, "ERR numéro de partie manquant");
+		return;
+	}
+	partie * p = trouver_partie(id);
+	if (p == NULL){
+		strcpy(reponse, "ERR partie inconnue");
+		return;
+	}
+	if (((strcmp(commande, "place") == 0 || strcmp(commande, "insert") == 0)
+			&& sscanf(ligne, "%*s %*d %d %d", &a, &b) != 2)
+			|| (strcmp(commande, "move") == 0 && sscanf(ligne, "%*s %*d %d %d %d %d", &a, &b, &x, &y) != 4)){
+		sprintf(reponse, "ERR syntaxe : %s id %s", commande, strcmp(commande, "move") == 0 ? "l1 c1 l2 c2" : "l c");
+		return;
+	}
+	long long debut = maintenant();
+	if (strcmp(commande, "place") == 0){
+		ret = place_piece(p->game, a, b);
+	}
+	else if (strcmp(commande, "move") == 0){
+		ret = quick_move(p->game, a, b, x, y);
+	}
+	else if (strcmp(commande, "insert") == 0){
+		ret = insert_pawn(p->game, a, b);
+	}
+	else if (strcmp(commande, "ai") == 0){
+		ret = jouer_coup_aleatoire(p->game, &p->graine) ? OK : RULES;
+	}
+	else if (strcmp(commande, "state") == 0){
+		decrire_partie(p->game, reponse);
+		return;
+	}
+	else if (strcmp(commande, "stats") == 0){
+		sprintf(reponse, "OK %ld %lld %lld", p->nb_coups,
+			p->nb_coups == 0 ? 0 : p->latence_totale / p->nb_coups, p->latence_max);
+		return;
+	}
+	else if (strcmp(commande, "end") == 0){
+		destroy_game(p->game);
+		p->game = NULL;
+		strcpy(reponse, "OK");
+		return;
+	}
+	else {
+		strcpy(reponse, "ERR commande inconnue");
+		return;
+	}
+	long long latence = maintenant() - debut;
+	p->nb_coups++;
+	p->latence_totale += latence;
+	if (latence > p->latence_max){
+		p->latence_max = latence;
+	}
+	strcpy(reponse, noms_retour[ret]);
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui exécute les commandes complètes reçues du client, tant que son tampon de sortie
+  peut contenir une réponse de plus*/
+void traiter_commandes(client * cl){
+	char reponse[TAILLE_REPONSE];
+	char * debut = cl->entree;
+	char * fin;
+	cl->entree[cl->taille_entree] = '\0';
+	while (cl->taille_sortie + TAILLE_REPONSE + 1 <= TAILLE_SORTIE && (fin = strchr(debut, '\n')) != NULL){
+		*fin = '\0';
+		executer_commande(debut, reponse);
+		cl->taille_sortie += sprintf(cl->sortie + cl->taille_sortie, "%s\n", reponse);
+		debut = fin + 1;
+	}
+	cl->taille_entree -= debut - cl->entree;
+	memmove(cl->entree, debut, cl->taille_entree);
+	/*Une ligne plus longue que le tampon n'est pas une commande valide*/
+	if (cl->taille_entree == TAILLE_TAMPON - 1 && strchr(cl->entree, '\n') == NULL){
+		cl->taille_entree = 0;
+	}
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui indique si le serveur doit lire les commandes du client : il faut de la place
+  dans son tampon d'entrée et de quoi répondre à au moins une commande*/
+int peut_lire(client * cl){
+	return cl->taille_entree < TAILLE_TAMPON - 1 && cl->taille_sortie + TAILLE_REPONSE + 1 <= TAILLE_SORTIE;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui lit ce que le client a envoyé. Renvoie 0 si le client s'est déconnecté*/
+int lire_client(int fd, client * cl){
+	ssize_t lus = read(fd, cl->entree + cl->taille_entree, TAILLE_TAMPON - 1 - cl->taille_entree);
+	if (lus < 0){
+		return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+	}
+	if (lus == 0){
+		return 0;
+	}
+	cl->taille_entree += lus;
+	return 1;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui envoie ce que la socket accepte du tampon de sortie. Renvoie 0 en cas d'erreur*/
+int ecrire_client(int fd, client * cl){
+	ssize_t ecrits = write(fd, cl->sortie, cl->taille_sortie);
+	if (ecrits < 0){
+		return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+	}
+	cl->taille_sortie -= ecrits;
+	memmove(cl->sortie, cl->sortie + ecrits, cl->taille_sortie);
+	return 1;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction qui traite les événements poll() d'un client. Renvoie 0 s'il faut le déconnecter*/
+int servir_client(struct pollfd * pfd, client * cl){
+	if ((pfd->revents & (POLLOUT | POLLHUP | POLLERR)) && cl->taille_sortie > 0 && !ecrire_client(pfd->fd, cl)){
+		return 0;
+	}
+	if ((pfd->revents & (POLLIN | POLLHUP | POLLERR)) && peut_lire(cl) && !lire_client(pfd->fd, cl)){
+		return 0;
+	}
+	/*Les commandes en attente sont reprises dès que le tampon de sortie s'est vidé*/
+	traiter_commandes(cl);
+	if (cl->taille_sortie > 0 && !ecrire_client(pfd->fd, cl)){
+		return 0;
+	}
+	pfd->events = (peut_lire(cl) ? POLLIN : 0) | (cl->taille_sortie > 0 ? POLLOUT : 0);
+	return 1;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+/*Fonction appelée à la réception de SIGTERM ou SIGINT*/
+void arreter(int signal){
+	(void)signal;
+	arret = 1;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//
+//Programme:
+int main(int argc, char ** argv){
+	char * chemin = argc > 1 ? argv[1] : "/tmp/sae_jeu.sock";
+	struct sockaddr_un adresse;
+	memset(&adresse, 0, sizeof adresse);
+	adresse.sun_family = AF_UNIX;
+	strncpy(adresse.sun_path, chemin, sizeof adresse.sun_path - 1);
+	int ecoute = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(chemin);
+	if (ecoute < 0 || bind(ecoute, (struct sockaddr *)&adresse, sizeof adresse) < 0 || listen(ecoute, 128) < 0){
+		perror("socket");
+		return 1;
+	}
+	signal(SIGPIPE, SIG_IGN);
+	signal(SIGTERM, arreter);
+	signal(SIGINT, arreter);
+	srand(time(NULL));
+	printf("Serveur en attente sur %s\n", chemin);
+	int capacite = 16;
+	int nb_fds = 1;
+	struct pollfd * fds = malloc(capacite * sizeof(struct pollfd));
+	client * clients = malloc(capacite * sizeof(client));
+	fds[0].fd = ecoute;
+	fds[0].events = POLLIN;
+	/*poll() se réveille chaque seconde pour voir arret, même si le signal arrive juste avant l'appel*/
+	while (!arret){
+		if (poll(fds, nb_fds, 1000) < 0){
+			if (errno == EINTR){
+				continue;
+			}
+			perror("poll");
+			return 1;
+		}
+		for (int i = nb_fds - 1; i > 0; i--){
+			if (fds[i].revents != 0 && !servir_client(&fds[i], &clients[i])){
+				close(fds[i].fd);
+				nb_fds--;
+				fds[i] = fds[nb_fds];
+				clients[i] = clients[nb_fds];
+			}
+		}
+		if (fds[0].revents & POLLIN){
+			int fd = accept(ecoute, NULL, NULL);
+			if (fd >= 0){
+				fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+				if (nb_fds == capacite){
+					capacite *= 2;
+					fds = realloc(fds, capacite * sizeof(struct pollfd));
+					clients = realloc(clients, capacite * sizeof(client));
+				}
+				fds[nb_fds].fd = fd;
+				fds[nb_fds].events = POLLIN;
+				fds[nb_fds].revents = 0;
+				clients[nb_fds].taille_entree = 0;
+				clients[nb_fds].taille_sortie = 0;
+				nb_fds++;
+			}
+		}
+	}
+	for (int i = 0; i < nb_fds; i++){
+		close(fds[i].fd);
+	}
+	unlink(chemin);
+	free(fds);
+	free(clients);
+	printf("Serveur arrêté\n");
+	return 0;
+}
+//-------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------//